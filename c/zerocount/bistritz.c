@@ -10,10 +10,27 @@
 #include "flint/flint.h"
 #include "flint/fmpz.h"
 #include "flint/fmpq.h"
+#include "flint/fmpz_poly.h"
 #include "flint/fmpq_poly.h"
 
 #include "debug.h"
 
+/**
+	@brief		Degree threshold of the divide-and-conquer recurrence
+	@details	Below this degree the classic step-by-step loop is expected to be faster. The default is provisional: it has not been tuned against FLINT. Can be tuned at compile time by -DBISTRITZ_HGCD_CUTOFF=n.
+*/
+#ifndef BISTRITZ_HGCD_CUTOFF
+	#define BISTRITZ_HGCD_CUTOFF 2400
+#endif
+
+/**
+	@brief		Precision threshold of the divide-and-conquer recursion
+	@details	Below this precision the steps of a block are made one by one. Can be tuned at compile time by -DBISTRITZ_HGCD_BASECASE=n.
+*/
+#ifndef BISTRITZ_HGCD_BASECASE
+	#define BISTRITZ_HGCD_BASECASE 32
+#endif
+
 
 /**
 	@brief		Returns the index of lowest non-zero term;
@@ -219,19 +236,17 @@ void eval_at_1_sym(fmpq_t val, const fmpq_poly_t poly) {
 	}
 
 /**
-	@brief		Repeatedly divides P(x) by (x-1) until P(-1)<>0, returns quotient.
-	@details	Quotient polynomial is obtained by a Horner-like evaluation at x=1
-	@param		count - multiplicity of root x=1 in P(x). If P(x)=0, 0 is returned.
+	@brief		Repeatedly divides P(x) by (x-root), root = 1 or -1, until P(root)<>0, returns quotient.
+	@details	P(root) is checked by summing the coefficients first; the quotient is obtained in place by a Horner-like evaluation at x=root, so no copy of P(x) is made per found factor.
+	@param		count - multiplicity of root in P(x). If P(x)=0, 0 is returned.
 	@param		poly - FLINT fmpq_poly_t type rational polynomial
-	@return		result is returned in count	
+	@param		root - FLINT slong type, 1 or -1
+	@return		result is returned in count, quotient in poly
 */
 
+void clear_x_pm_1(slong *count, fmpq_poly_t poly, const slong root) {
 	
-void clear_x_minus_1(slong *count, fmpq_poly_t poly) {
-	
-	fmpq_poly_t P;
-	
-	int cont;
+	fmpz_t val;
 	
 	/* debug */
 	DEBUG_ENTER_AT(2);
@@ -240,34 +255,278 @@ void clear_x_minus_1(slong *count, fmpq_poly_t poly) {
 	
 	if (fmpq_poly_length(poly) > 0) {
 		
-		fmpq_poly_init(P);
-		fmpq_poly_set(P, poly);
-		
-		cont = 1;
+		fmpz_init(val);
 		
 		do {
-			//Quotient polynomal by Horner-like evaluation at 1;
-			for (slong i = fmpq_poly_degree(P)-1; i >= 0; i--)
-				fmpz_add(P->coeffs+i, P->coeffs+i, P->coeffs+i+1);
+			//P(root)
+			fmpz_zero(val);
+			for (slong i = 0; i < poly->length; i++)
+				if ((root > 0) || (i % 2 == 0))
+					fmpz_add(val, val, poly->coeffs+i);
+				else
+					fmpz_sub(val, val, poly->coeffs+i);
 			
-			if (fmpz_is_zero(P->coeffs)) {
+			if (fmpz_is_zero(val)) {
 				
 				(*count)++;
-				fmpq_poly_shift_right(P, P, 1); //divide & forget the remainder
-				fmpq_poly_canonicalise(P);
-				fmpq_poly_set(poly, P);			//the result so far
+				
+				//Quotient polynomial by Horner-like evaluation at root, remainder is 0
+				for (slong i = fmpq_poly_degree(poly)-1; i >= 0; i--)
+					if (root > 0)
+						fmpz_add(poly->coeffs+i, poly->coeffs+i, poly->coeffs+i+1);
+					else
+						fmpz_sub(poly->coeffs+i, poly->coeffs+i, poly->coeffs+i+1);
+				
+				fmpq_poly_shift_right(poly, poly, 1);	//divide & forget the remainder
 			}
-			else cont = 0;
 			
-		} while (cont);
-		fmpq_poly_clear(P);
+		} while (fmpz_is_zero(val) && (fmpq_poly_degree(poly) > 0));
+		
+		fmpq_poly_canonicalise(poly);
+		
+		fmpz_clear(val);
 	}
 	
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+	
+	return;
+}
+
+/**
+	@brief		Splits f(x) into its even and odd parts, f(x) = E(x^2) + x*O(x^2).
+	@param		E, O - FLINT fmpz_poly_t type integer polynomials, must not alias f
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in E and O
+*/
+
+void even_odd_parts(fmpz_poly_t E, fmpz_poly_t O, const fmpz_poly_t f) {
+	
+	fmpz_poly_zero(E);
+	fmpz_poly_zero(O);
+	
+	for (slong i = fmpz_poly_length(f)-1; i >= 0; i--)
+		if (i % 2 == 0)
+			fmpz_poly_set_coeff_fmpz(E, i/2, f->coeffs+i);
+		else
+			fmpz_poly_set_coeff_fmpz(O, i/2, f->coeffs+i);
+	
 	return;
+}
+
+/**
+	@brief		Replaces f(x) by f(x^2) in place.
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in f
+*/
+
+void inflate_x2(fmpz_poly_t f) {
+	
+	slong len = fmpz_poly_length(f);
+	
+	if (len > 1) {
+		
+		fmpz_poly_fit_length(f, 2*len-1);
+		
+		for (slong i = len-1; i > 0; i--) {
+			fmpz_swap(f->coeffs+2*i, f->coeffs+i);
+			fmpz_zero(f->coeffs+2*i-1);
+		}
+		
+		_fmpz_poly_set_length(f, 2*len-1);
+	}
+	
+	return;
+}
+
+/**
+	@brief		Replaces f(x) by f(-x) in place.
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in f
+*/
+
+void reflect_x(fmpz_poly_t f) {
+	
+	for (slong i = 1; i < fmpz_poly_length(f); i += 2)
+		fmpz_neg(f->coeffs+i, f->coeffs+i);
+	
+	return;
+}
+
+/**
+	@brief		Computes the product of all cyclotomic factors Phi_k(x) with odd k of a square-free f(x), f(0) != 0.
+	@details	Graeffe root squaring: G(x^2) = +-f(x)f(-x) has the squares of the zeros of f(x) as its zeros. Repeating f = gcd(f, G) keeps the zeros that are squares of zeros of the previous f(x). At the fixed point squaring maps the finite set of zeros onto itself, hence bijectively, so the zeros are roots of unity of odd order; primitive k-th roots of unity with odd k are never removed, as squaring permutes them.
+	@param		A - FLINT fmpz_poly_t type integer polynomial
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in A, a product of distinct Phi_k(x) with odd k
+*/
+
+void odd_cyclotomic_part(fmpz_poly_t A, const fmpz_poly_t f) {
+	
+	fmpz_poly_t E, O, G;
+	
+	fmpz_poly_init(E);
+	fmpz_poly_init(O);
+	fmpz_poly_init(G);
+	
+	fmpz_poly_set(A, f);
+	
+	while (fmpz_poly_degree(A) > 0) {
+		
+		//Graeffe transform G(x) = E(x)^2 - x*O(x)^2
+		even_odd_parts(E, O, A);
+		fmpz_poly_sqr(E, E);
+		fmpz_poly_sqr(O, O);
+		fmpz_poly_shift_left(O, O, 1);
+		fmpz_poly_sub(G, E, O);
+		
+		fmpz_poly_gcd(G, A, G);
+		
+		if (fmpz_poly_degree(G) == fmpz_poly_degree(A))
+			break;
+		
+		fmpz_poly_swap(A, G);
+	}
+	
+	fmpz_poly_clear(E);
+	fmpz_poly_clear(O);
+	fmpz_poly_clear(G);
+	
+	return;
+}
+
+/**
+	@brief		Computes the product of all distinct cyclotomic factors of a square-free f(x), f(0) != 0.
+	@details	Bradford-Davenport method: a few GCD computations on each of at most log2(deg f) recursion levels. Phi_k(x) with odd k are found by odd_cyclotomic_part, with k = 2 mod 4 - by the same method applied to f(-x), since Phi_k(x) = Phi_{k/2}(-x). If 4 | k, Phi_k(x) = Phi_{k/2}(x^2) divides both E(x^2) and O(x^2) of f(x) = E(x^2) + x*O(x^2), so these are found recursively from gcd(E, O), which has at most half the degree of f(x).
+	@param		C - FLINT fmpz_poly_t type integer polynomial
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in C, 1 if f(x) has no cyclotomic factors
+*/
+
+void cyclotomic_part(fmpz_poly_t C, const fmpz_poly_t f) {
+	
+	fmpz_poly_t E, O, T, G;
 	
 	/* debug */
-	DEBUG_LEAVE_AT(2);
+	DEBUG_ENTER_AT(3);
+	
+	fmpz_poly_one(C);
+	
+	if (fmpz_poly_degree(f) > 0) {
+		
+		fmpz_poly_init(E);
+		fmpz_poly_init(O);
+		fmpz_poly_init(T);
+		fmpz_poly_init(G);
+		
+		//k odd
+		odd_cyclotomic_part(C, f);
+		
+		//k = 2 mod 4, coprime to the odd part
+		fmpz_poly_set(T, f);
+		reflect_x(T);
+		odd_cyclotomic_part(T, T);
+		reflect_x(T);
+		fmpz_poly_mul(C, C, T);
+		
+		//k = 0 mod 4
+		even_odd_parts(E, O, f);
+		fmpz_poly_gcd(G, E, O);
+		
+		if (fmpz_poly_degree(G) > 0) {
+			
+			cyclotomic_part(T, G);
+			inflate_x2(T);
+			fmpz_poly_gcd(G, C, T);
+			fmpz_poly_div(T, T, G);
+			fmpz_poly_mul(C, C, T);
+		}
+		
+		fmpz_poly_clear(E);
+		fmpz_poly_clear(O);
+		fmpz_poly_clear(T);
+		fmpz_poly_clear(G);
 	}
+	
+	/* debug */
+	DEBUG_LEAVE_AT(3);
+	
+	return;
+}
+
+/**
+	@brief		Removes all cyclotomic factors from P(x), returns the number of removed zeros.
+	@details	(x-1) and (x+1) are removed first by clear_x_pm_1. Every other cyclotomic factor divides the reciprocal part R = gcd(P, P*), which is usually of small degree; the product C of distinct cyclotomic factors of the square-free part of R is found by cyclotomic_part, then P is divided by C and C is replaced by gcd(C, P) until C = 1, which accounts for the multiplicities. All removed zeros lie on the unit circle. The quotient is returned as a primitive integer polynomial, which has the same zeros as P(x).
+	@param		count - number of zeros of the removed cyclotomic factors, counted with multiplicities. If P(x)=0, 0 is returned.
+	@param		poly - FLINT fmpq_poly_t type rational polynomial
+	@return		result is returned in count, quotient in poly
+*/
+
+void clear_cyclotomic(slong *count, fmpq_poly_t poly) {
+	
+	fmpz_poly_t N, R, C;
+	
+	slong mult;
+	
+	/* debug */
+	DEBUG_ENTER_AT(2);
+	
+	*count = 0;
+	
+	if (fmpq_poly_length(poly) > 0) {
+		
+		clear_x_pm_1(&mult, poly, 1);
+		*count += mult;
+		
+		clear_x_pm_1(&mult, poly, -1);
+		*count += mult;
+		
+		fmpz_poly_init(N);
+		fmpz_poly_init(R);
+		fmpz_poly_init(C);
+		
+		fmpq_poly_get_numerator(N, poly);
+		
+		//reciprocal part, R(0) != 0
+		fmpz_poly_reverse(R, N, fmpz_poly_length(N));
+		fmpz_poly_gcd(R, N, R);
+		
+		/* debug */
+		DEBUG_MSG_AT(2, "# degree of the reciprocal part: %wd\n", fmpz_poly_degree(R));
+		
+		if (fmpz_poly_degree(R) >= 2) {
+			
+			//square-free part
+			fmpz_poly_derivative(C, R);
+			fmpz_poly_gcd(C, R, C);
+			fmpz_poly_div(R, R, C);
+			
+			cyclotomic_part(C, R);
+			
+			while (fmpz_poly_degree(C) > 0) {
+				
+				/* debug */
+				DEBUG_MSG_AT(2, "# cyclotomic factor of degree %wd found\n", fmpz_poly_degree(C));
+				
+				fmpz_poly_div(N, N, C);
+				*count += fmpz_poly_degree(C);
+				fmpz_poly_gcd(C, C, N);
+			}
+		}
+		
+		fmpz_poly_primitive_part(N, N);
+		fmpq_poly_set_fmpz_poly(poly, N);
+		
+		fmpz_poly_clear(N);
+		fmpz_poly_clear(R);
+		fmpz_poly_clear(C);
+	}
+	
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+	
+	return;
+}
 
 /**
 	@brief		Initializes polynomials T1, T2 and their signs at x=1
@@ -469,6 +728,466 @@ void do_recurence(fmpq_poly_t T3, 					//next polynomial T
 	
 }
 
+/**
+	@brief		2x2 transition matrix of several regular Bistritz steps
+	@details	z^shift*(T_{k+1-s}, T_{k-s}) = M*(T_{k+1}, T_k)/den, where M = (m11, m12; m21, m22) has integer polynomial entries and s is the number of steps. Keeping a single denominator avoids canonicalising every rational entry after each operation.
+*/
+typedef struct {
+	fmpz_poly_t m11;
+	fmpz_poly_t m12;
+	fmpz_poly_t m21;
+	fmpz_poly_t m22;
+	fmpz_t den;
+	slong shift;
+} bistritz_mat_struct;
+
+typedef bistritz_mat_struct bistritz_mat_t[1];
+
+/**
+	@brief		Initializes the transition matrix to the identity
+	@param		M - bistritz_mat_t matrix
+*/
+void bistritz_mat_init(bistritz_mat_t M) {
+	
+	fmpz_poly_init(M->m11);
+	fmpz_poly_init(M->m12);
+	fmpz_poly_init(M->m21);
+	fmpz_poly_init(M->m22);
+	fmpz_init(M->den);
+	
+	fmpz_poly_one(M->m11);
+	fmpz_poly_one(M->m22);
+	fmpz_one(M->den);
+	M->shift = 0;
+	
+	return;
+}
+
+/**
+	@brief		Releases the memory used by the transition matrix
+	@param		M - bistritz_mat_t matrix
+*/
+void bistritz_mat_clear(bistritz_mat_t M) {
+	
+	fmpz_poly_clear(M->m11);
+	fmpz_poly_clear(M->m12);
+	fmpz_poly_clear(M->m21);
+	fmpz_poly_clear(M->m22);
+	fmpz_clear(M->den);
+	
+	return;
+}
+
+/**
+	@brief		Swaps two transition matrices
+	@param		M - bistritz_mat_t matrix
+	@param		N - bistritz_mat_t matrix
+*/
+void bistritz_mat_swap(bistritz_mat_t M, bistritz_mat_t N) {
+	
+	slong shift;
+	
+	fmpz_poly_swap(M->m11, N->m11);
+	fmpz_poly_swap(M->m12, N->m12);
+	fmpz_poly_swap(M->m21, N->m21);
+	fmpz_poly_swap(M->m22, N->m22);
+	fmpz_swap(M->den, N->den);
+	
+	shift = M->shift;
+	M->shift = N->shift;
+	N->shift = shift;
+	
+	return;
+}
+
+/**
+	@brief		Replaces g by gcd(g, content of poly), stops as soon as g = 1
+	@param		g - FLINT fmpz_t type number
+	@param		poly - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in g
+*/
+void gcd_content(fmpz_t g, const fmpz_poly_t poly) {
+	
+	for (slong i = 0; (i < poly->length) && !fmpz_is_one(g); i++)
+		fmpz_gcd(g, g, poly->coeffs+i);
+	
+	return;
+}
+
+/**
+	@brief		Removes the common factor of the entries of the transition matrix and its denominator
+	@param		M - bistritz_mat_t matrix
+	@return		result is returned in M
+*/
+void bistritz_mat_reduce(bistritz_mat_t M) {
+	
+	fmpz_t g;
+	
+	fmpz_init(g);
+	
+	fmpz_set(g, M->den);
+	gcd_content(g, M->m11);
+	gcd_content(g, M->m12);
+	gcd_content(g, M->m21);
+	gcd_content(g, M->m22);
+	
+	if (!fmpz_is_one(g)) {
+		fmpz_poly_scalar_divexact_fmpz(M->m11, M->m11, g);
+		fmpz_poly_scalar_divexact_fmpz(M->m12, M->m12, g);
+		fmpz_poly_scalar_divexact_fmpz(M->m21, M->m21, g);
+		fmpz_poly_scalar_divexact_fmpz(M->m22, M->m22, g);
+		fmpz_divexact(M->den, M->den, g);
+	}
+	
+	fmpz_clear(g);
+	
+	return;
+}
+
+/**
+	@brief		Product of transition matrices M = M2*M1 by FLINT fast polynomial multiplication
+	@param		M - bistritz_mat_t result, must not be aliased with M1 or M2
+	@param		M2 - bistritz_mat_t matrix of the later steps
+	@param		M1 - bistritz_mat_t matrix of the earlier steps
+	@return		result is returned in M
+*/
+void bistritz_mat_mul(bistritz_mat_t M, const bistritz_mat_t M2, const bistritz_mat_t M1) {
+	
+	fmpz_poly_t tmp;
+	
+	fmpz_poly_init(tmp);
+	
+	fmpz_poly_mul(M->m11, M2->m11, M1->m11);
+	fmpz_poly_mul(tmp, M2->m12, M1->m21);
+	fmpz_poly_add(M->m11, M->m11, tmp);
+	
+	fmpz_poly_mul(M->m12, M2->m11, M1->m12);
+	fmpz_poly_mul(tmp, M2->m12, M1->m22);
+	fmpz_poly_add(M->m12, M->m12, tmp);
+	
+	fmpz_poly_mul(M->m21, M2->m21, M1->m11);
+	fmpz_poly_mul(tmp, M2->m22, M1->m21);
+	fmpz_poly_add(M->m21, M->m21, tmp);
+	
+	fmpz_poly_mul(M->m22, M2->m21, M1->m12);
+	fmpz_poly_mul(tmp, M2->m22, M1->m22);
+	fmpz_poly_add(M->m22, M->m22, tmp);
+	
+	fmpz_mul(M->den, M2->den, M1->den);
+	M->shift = M2->shift + M1->shift;
+	
+	bistritz_mat_reduce(M);
+	
+	fmpz_poly_clear(tmp);
+	
+	return;
+}
+
+/**
+	@brief		Removes the common content of the pair of integer polynomials A, B
+	@details	The recurrence is homogeneous: scaling T_{k+1} and T_k by the same constant does not change the delta coefficients of the next steps.
+	@param		A - FLINT fmpz_poly_t type integer polynomial
+	@param		B - FLINT fmpz_poly_t type integer polynomial
+	@return		results are returned in A, B
+*/
+void pair_reduce(fmpz_poly_t A, fmpz_poly_t B) {
+	
+	fmpz_t g;
+	
+	fmpz_init(g);
+	
+	gcd_content(g, A);
+	gcd_content(g, B);
+	
+	if (!fmpz_is_zero(g) && !fmpz_is_one(g)) {
+		fmpz_poly_scalar_divexact_fmpz(A, A, g);
+		fmpz_poly_scalar_divexact_fmpz(B, B, g);
+	}
+	
+	fmpz_clear(g);
+	
+	return;
+}
+
+/**
+	@brief		Applies the transition matrix: (A_next, B_next) = M*(A, B)/z^shift, up to the common factor 1/den
+	@details	If prec > 0, A and B are only known modulo z^prec and the result is known modulo z^(prec-shift); if prec <= 0, A and B are exact polynomials and so is the result.
+	@param		A_next - FLINT fmpz_poly_t type result
+	@param		B_next - FLINT fmpz_poly_t type result
+	@param		M - bistritz_mat_t matrix
+	@param		A - FLINT fmpz_poly_t type polynomial T_{k+1}, up to a constant factor
+	@param		B - FLINT fmpz_poly_t type polynomial T_k, up to the same factor
+	@param		prec - FLINT slong type precision of A and B
+	@return		results are returned in A_next, B_next
+*/
+void bistritz_mat_apply(fmpz_poly_t A_next, fmpz_poly_t B_next, const bistritz_mat_t M, const fmpz_poly_t A, const fmpz_poly_t B, const slong prec) {
+	
+	fmpz_poly_t tmp;
+	
+	fmpz_poly_init(tmp);
+	
+	if (prec > 0) {
+		fmpz_poly_mullow(A_next, M->m11, A, prec);
+		fmpz_poly_mullow(tmp, M->m12, B, prec);
+		fmpz_poly_add(A_next, A_next, tmp);
+		
+		fmpz_poly_mullow(B_next, M->m21, A, prec);
+		fmpz_poly_mullow(tmp, M->m22, B, prec);
+		fmpz_poly_add(B_next, B_next, tmp);
+	}
+	else {
+		fmpz_poly_mul(A_next, M->m11, A);
+		fmpz_poly_mul(tmp, M->m12, B);
+		fmpz_poly_add(A_next, A_next, tmp);
+		
+		fmpz_poly_mul(B_next, M->m21, A);
+		fmpz_poly_mul(tmp, M->m22, B);
+		fmpz_poly_add(B_next, B_next, tmp);
+	}
+	
+	fmpz_poly_shift_right(A_next, A_next, M->shift);
+	fmpz_poly_shift_right(B_next, B_next, M->shift);
+	
+	fmpz_poly_clear(tmp);
+	
+	return;
+}
+
+/**
+	@brief		Performs regular Bistritz steps one by one on A, B known modulo z^prec and accumulates their transition matrix
+	@details	Step with lambda = lambda(B) and delta = p/q is z*C = delta*(z^(lambda+1)+z^(-lambda))*B - A and costs lambda+1 coefficients of precision. It is done on integer polynomials as (B, C) = (q*B, p*(z^(lambda+1)+z^(-lambda))*B - q*A)/z, its matrix is (0, q*z^(lambda+1); -q*z^lambda, p*(z^(2*lambda+1)+1)) with denominator q. Stops when max_steps steps are done, when the precision is exhausted, or when B vanishes modulo z^prec, so that lambda(B) is unknown (this includes the singular case).
+	@param		M - bistritz_mat_t transition matrix of the performed steps
+	@param		deltas - array of FLINT fmpq type, receives delta coefficient of every step
+	@param		A_in - FLINT fmpz_poly_t type polynomial T_{k+1}, up to a constant factor
+	@param		B_in - FLINT fmpz_poly_t type polynomial T_k, up to the same factor
+	@param		prec - FLINT slong type precision of A_in and B_in
+	@param		max_steps - FLINT slong type maximal number of steps
+	@return		number of performed steps
+*/
+slong hgcd_base(bistritz_mat_t M, fmpq *deltas, const fmpz_poly_t A_in, const fmpz_poly_t B_in, slong prec, const slong max_steps) {
+	
+	fmpz_poly_t A, B, C, tmp;
+	
+	fmpz_t p;
+	
+	slong lambda, steps;
+	
+	/* debug */
+	DEBUG_ENTER_AT(3);
+	
+	fmpz_poly_init(A);
+	fmpz_poly_init(B);
+	fmpz_poly_init(C);
+	fmpz_poly_init(tmp);
+	fmpz_init(p);
+	
+	fmpz_poly_set(A, A_in);
+	fmpz_poly_set(B, B_in);
+	fmpz_poly_truncate(A, prec);
+	fmpz_poly_truncate(B, prec);
+	
+	fmpz_poly_one(M->m11);
+	fmpz_poly_zero(M->m12);
+	fmpz_poly_zero(M->m21);
+	fmpz_poly_one(M->m22);
+	fmpz_one(M->den);
+	M->shift = 0;
+	
+	steps = 0;
+	
+	while ((steps < max_steps) && (prec >= 1) && !fmpz_poly_is_zero(B)) {
+		
+		for (lambda = 0; fmpz_is_zero(B->coeffs+lambda); lambda++);
+		
+		//delta = p/q in lowest terms
+		fmpz_poly_get_coeff_fmpz(p, A, 0);
+		fmpq_set_fmpz_frac(deltas+steps, p, B->coeffs+lambda);
+		
+		//next polynomial, known modulo z^(prec-lambda-1)
+		fmpz_poly_shift_left(C, B, lambda+1);
+		fmpz_poly_shift_right(tmp, B, lambda);
+		fmpz_poly_add(C, C, tmp);
+		fmpz_poly_scalar_mul_fmpz(C, C, &(deltas[steps].num));
+		fmpz_poly_scalar_mul_fmpz(tmp, A, &(deltas[steps].den));
+		fmpz_poly_sub(C, C, tmp);
+		fmpz_poly_shift_right(C, C, 1);
+		
+		prec -= lambda+1;
+		
+		fmpz_poly_truncate(C, prec);
+		fmpz_poly_truncate(B, prec);
+		fmpz_poly_scalar_mul_fmpz(B, B, &(deltas[steps].den));
+		pair_reduce(B, C);
+		fmpz_poly_swap(A, B);
+		fmpz_poly_swap(B, C);
+		
+		//M = (0, q*z^(lambda+1); -q*z^lambda, p*(z^(2*lambda+1)+1))*M/q
+		fmpz_poly_scalar_mul_fmpz(tmp, M->m21, &(deltas[steps].num));
+		fmpz_poly_shift_left(C, tmp, 2*lambda+1);
+		fmpz_poly_add(tmp, tmp, C);
+		fmpz_poly_scalar_mul_fmpz(C, M->m11, &(deltas[steps].den));
+		fmpz_poly_shift_left(C, C, lambda);
+		fmpz_poly_sub(tmp, tmp, C);
+		fmpz_poly_scalar_mul_fmpz(C, M->m21, &(deltas[steps].den));
+		fmpz_poly_shift_left(M->m11, C, lambda+1);
+		fmpz_poly_swap(M->m21, tmp);
+		
+		fmpz_poly_scalar_mul_fmpz(tmp, M->m22, &(deltas[steps].num));
+		fmpz_poly_shift_left(C, tmp, 2*lambda+1);
+		fmpz_poly_add(tmp, tmp, C);
+		fmpz_poly_scalar_mul_fmpz(C, M->m12, &(deltas[steps].den));
+		fmpz_poly_shift_left(C, C, lambda);
+		fmpz_poly_sub(tmp, tmp, C);
+		fmpz_poly_scalar_mul_fmpz(C, M->m22, &(deltas[steps].den));
+		fmpz_poly_shift_left(M->m12, C, lambda+1);
+		fmpz_poly_swap(M->m22, tmp);
+		
+		fmpz_mul(M->den, M->den, &(deltas[steps].den));
+		bistritz_mat_reduce(M);
+		
+		M->shift += lambda+1;
+		steps++;
+	}
+	
+	fmpz_poly_clear(A);
+	fmpz_poly_clear(B);
+	fmpz_poly_clear(C);
+	fmpz_poly_clear(tmp);
+	fmpz_clear(p);
+	
+	/* debug */
+	DEBUG_LEAVE_AT(3);
+	
+	return(steps);
+}
+
+/**
+	@brief		Divide-and-conquer (half-gcd style) computation of the transition matrix of regular Bistritz steps
+	@details	The steps depend only on the lowest coefficients of T_{k+1}, T_k: the first half of the precision gives the first matrix M1, which is applied to A, B by fast truncated multiplication; the rest of the precision gives M2, and M = M2*M1. Below BISTRITZ_HGCD_BASECASE the steps are done one by one by hgcd_base.
+	@param		M - bistritz_mat_t transition matrix of the performed steps
+	@param		deltas - array of FLINT fmpq type, receives delta coefficient of every step
+	@param		A - FLINT fmpz_poly_t type polynomial T_{k+1}, up to a constant factor
+	@param		B - FLINT fmpz_poly_t type polynomial T_k, up to the same factor
+	@param		prec - FLINT slong type precision of A and B: only coefficients of z^0...z^(prec-1) are used
+	@param		max_steps - FLINT slong type maximal number of steps
+	@return		number of performed steps
+*/
+slong hgcd_rec(bistritz_mat_t M, fmpq *deltas, const fmpz_poly_t A, const fmpz_poly_t B, const slong prec, const slong max_steps) {
+	
+	bistritz_mat_t M1, M2;
+	
+	fmpz_poly_t A1, B1;
+	
+	slong steps;
+	
+	if (prec <= BISTRITZ_HGCD_BASECASE)
+		return(hgcd_base(M, deltas, A, B, prec, max_steps));
+	
+	/* debug */
+	DEBUG_ENTER_AT(3);
+	
+	bistritz_mat_init(M1);
+	
+	steps = hgcd_rec(M1, deltas, A, B, prec/2, max_steps);
+	
+	//lambda(B) is too large for the first half: make a single step with the full precision
+	if (steps == 0)
+		steps = hgcd_base(M1, deltas, A, B, prec, 1);
+	
+	if ((steps > 0) && (steps < max_steps) && (M1->shift < prec)) {
+		
+		bistritz_mat_init(M2);
+		fmpz_poly_init(A1);
+		fmpz_poly_init(B1);
+		
+		bistritz_mat_apply(A1, B1, M1, A, B, prec);
+		pair_reduce(A1, B1);
+		steps += hgcd_rec(M2, deltas+steps, A1, B1, prec - M1->shift, max_steps - steps);
+		bistritz_mat_mul(M, M2, M1);
+		
+		bistritz_mat_clear(M2);
+		fmpz_poly_clear(A1);
+		fmpz_poly_clear(B1);
+	}
+	else
+		bistritz_mat_swap(M, M1);
+	
+	bistritz_mat_clear(M1);
+	
+	/* debug */
+	DEBUG_LEAVE_AT(3);
+	
+	return(steps);
+}
+
+/**
+	@brief		Advances the recurrence by the regular steps determined by the lower half of the coefficients, at most max_steps
+	@details	As in the half-gcd based gcd, only the matrix of the first half of the steps is computed and then applied exactly, the caller continues with the rest; this avoids the product of the two largest matrices. On entry T_prev = T_{k+1}, T_curr = T_k, with formal lengths k+2, k+1; on exit T_prev = T_{k+1-s}, T_curr = T_{k-s}, where s is the returned number of steps. The delta coefficients of the steps are stored in deltas, so that the signs at x=1 follow by sigma_{j-1} = 2*delta*sigma_j - sigma_{j+1}. Returns 0 if T_curr = 0 or lambda(T_curr) is too large, which must be handled by the classic step. The coefficients of T_k have O(n-k) bits, so the total size of the recurrence is O(n^2) bits and the cost is at best quasi-quadratic in bit operations, against cubic for the classic loop; whether degrees of order 10^4 - 10^5 are practical with FLINT has not been measured.
+	@param		T_prev - FLINT fmpq_poly_t type pre-previous polynomial of the recurrence
+	@param		T_curr - FLINT fmpq_poly_t type previous polynomial of the recurrence
+	@param		deltas - array of at least max_steps initialized FLINT fmpq type numbers
+	@param		max_steps - FLINT slong type maximal number of steps, at most k
+	@return		number of performed steps
+*/
+slong do_recurence_hgcd(fmpq_poly_t T_prev, fmpq_poly_t T_curr, fmpq *deltas, const slong max_steps) {
+	
+	bistritz_mat_t M;
+	
+	fmpz_poly_t A, B, A_next, B_next;
+	
+	fmpz_t den;
+	
+	slong steps;
+	
+	/* debug */
+	DEBUG_ENTER_AT(2);
+	
+	bistritz_mat_init(M);
+	fmpz_poly_init(A);
+	fmpz_poly_init(B);
+	fmpz_init(den);
+	
+	//integer pair (A, B) = den*(T_prev, T_curr)
+	fmpq_poly_get_numerator(A, T_prev);
+	fmpz_poly_scalar_mul_fmpz(A, A, T_curr->den);
+	fmpq_poly_get_numerator(B, T_curr);
+	fmpz_poly_scalar_mul_fmpz(B, B, T_prev->den);
+	fmpz_mul(den, T_prev->den, T_curr->den);
+	
+	//T_prev, T_curr are exact, the lower half of their coefficients fixes about a half of the steps
+	steps = hgcd_rec(M, deltas, A, B, max_steps/2+2, max_steps);
+	
+	if (steps > 0) {
+		
+		fmpz_poly_init(A_next);
+		fmpz_poly_init(B_next);
+		
+		bistritz_mat_apply(A_next, B_next, M, A, B, 0);
+		fmpz_mul(den, den, M->den);
+		
+		fmpq_poly_set_fmpz_poly(T_prev, A_next);
+		fmpq_poly_scalar_div_fmpz(T_prev, T_prev, den);
+		fmpq_poly_set_fmpz_poly(T_curr, B_next);
+		fmpq_poly_scalar_div_fmpz(T_curr, T_curr, den);
+		
+		fmpz_poly_clear(A_next);
+		fmpz_poly_clear(B_next);
+	}
+	
+	/* debug */
+	DEBUG_MSG_AT(2, "# %wd regular steps done by divide-and-conquer\n", steps);
+	
+	bistritz_mat_clear(M);
+	fmpz_poly_clear(A);
+	fmpz_poly_clear(B);
+	fmpz_clear(den);
+	
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+	
+	return(steps);
+}
+
 /**
 	@brief		Zero counting procedure
 	@details	If poly <> 0, returns no. of complex zeros of poly inside |z| < 1 and on |z| = 1 through *in_uc and *on_uc. If poly == 0, stores the pair of numbers -1, 0.
@@ -483,9 +1202,11 @@ void Bistritz_rule(slong *in_uc, slong *on_uc, const fmpq_poly_t poly) {
 	
 	fmpq_t sigma_prev, sigma_curr, sigma_next, delta;
 	
+	fmpq *deltas;
+	
 	fmpq_poly_t D, T_prev, T_curr, T_next;
 	
-	slong deg, last_sgn, curr_sgn, singular, vars, vars_reg;
+	slong deg, last_sgn, curr_sgn, singular, vars, vars_reg, steps;
 	
 	/* debug */
 	DEBUG_ENTER_AT(1);
@@ -512,19 +1233,28 @@ void Bistritz_rule(slong *in_uc, slong *on_uc, const fmpq_poly_t poly) {
 	DEBUG_FMPQ_POLY_AT(1, poly);
 	DEBUG_MSG_AT(1, "\n");
 	
+	//zeros of cyclotomic factors are counted directly, the recurrence runs on the cofactor
 	fmpq_poly_set(D, poly);
-	clear_x_minus_1(on_uc, D);
+	clear_cyclotomic(on_uc, D);
 	
 	deg = fmpq_poly_degree(D);
 	
 	/* debug */
-	DEBUG_MSG_AT(1, "# (x-1) factors cleared, degree deg=%wd\n# D = ", deg);
-	DEBUG_FMPQ_POLY_AT(1, poly);
+	DEBUG_MSG_AT(1, "# cyclotomic factors cleared, degree deg=%wd\n# D = ", deg);
+	DEBUG_FMPQ_POLY_AT(1, D);
 	DEBUG_MSG_AT(1, "\n");
 	
 	rule_init(T_prev, T_curr, sigma_prev, sigma_curr, D);
 	last_sgn = fmpq_sgn(sigma_prev);
 	
+	//delta coefficients of the divide-and-conquer steps
+	deltas = NULL;
+	if (deg > BISTRITZ_HGCD_CUTOFF) {
+		deltas = flint_malloc(deg*sizeof(fmpq));
+		for (slong j = 0; j < deg; j++)
+			fmpq_init(deltas+j);
+	}
+	
 	/* debug */
 	DEBUG_T(1, deg, T_prev, sigma_prev);
 	
@@ -534,6 +1264,34 @@ void Bistritz_rule(slong *in_uc, slong *on_uc, const fmpq_poly_t poly) {
 		DEBUG_MSG_AT(1, "# * loop i = %wd *\n", i);
 		DEBUG_T(1, i, T_curr, sigma_curr);
 		
+		//high degree: a block of regular steps at once, sigmas follow from the delta coefficients
+		if ((i > BISTRITZ_HGCD_CUTOFF) && !fmpq_poly_is_zero(T_curr)) {
+			
+			steps = do_recurence_hgcd(T_prev, T_curr, deltas, i);
+			
+			for (slong j = 0; j < steps; j++) {
+				
+				fmpq_mul(sigma_next, deltas+j, sigma_curr);
+				fmpq_mul_2exp(sigma_next, sigma_next, 1);
+				fmpq_sub(sigma_next, sigma_next, sigma_prev);
+				
+				/* Count sign variations */
+				curr_sgn = fmpq_sgn(sigma_curr);
+				vars += (1-last_sgn*curr_sgn)/2;
+				if (curr_sgn != 0)
+					last_sgn = curr_sgn;
+				
+				fmpq_swap(sigma_prev, sigma_curr);
+				fmpq_swap(sigma_curr, sigma_next);
+			}
+			
+			/* Step down from i to i-steps */
+			if (steps > 0) {
+				i -= steps-1;
+				continue;
+			}
+		}
+		
 		if (fmpq_poly_is_zero(T_curr)) {
 			
 			if (fmpq_poly_is_zero(T_prev))
@@ -602,6 +1360,12 @@ void Bistritz_rule(slong *in_uc, slong *on_uc, const fmpq_poly_t poly) {
 	fmpq_clear(sigma_next);
 	fmpq_clear (delta);
 	
+	if (deltas != NULL) {
+		for (slong j = 0; j < deg; j++)
+			fmpq_clear(deltas+j);
+		flint_free(deltas);
+	}
+	
 	fmpz_clear(const_null);
 	
 	DEBUG_LEAVE_AT(1);
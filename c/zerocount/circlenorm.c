@@ -0,0 +1,1060 @@
+/** @file		circlenorm.c
+	@brief		source code for the certified extrema of |f(z)| on the unit circle |z| = 1
+	@version	1.0
+	@note		FLINT version 2.5.2
+	@details	Native replacement for circle_min/circle_max of CirclePolyTools.sage. For f in Z[x], the self-reciprocal polynomial f(x)f*(x) is rewritten in the Chebyshev basis as g(y), so that |f(e^(it))|^2 = g(cos t) and the extrema of |f| on the circle become the extrema of g on [-1, 1]. Critical points of g are isolated exactly by Descartes rule of signs with dyadic bisection, then refined by bisection; the critical values are enclosed by the second order Taylor bound |g(xi) - g(m)| <= max|g''| (xi-m)^2 / 2. All arithmetic is exact, results are returned as rational enclosures. FLINT conventions are followed as in bistritz.c: each function returns its result via the 1st argument(s), arguments must be initialized by the user.
+*/
+
+#include "flint/flint.h"
+#include "flint/fmpz.h"
+#include "flint/fmpq.h"
+#include "flint/fmpz_poly.h"
+
+#include "debug.h"
+#include "zerocount.h"
+
+/**
+	@brief		Critical point of g(y) in (-1, 1), together with the enclosure of the critical value g(xi)
+	@details	The point xi is isolated in [a, b]; a = b if xi is known exactly.
+*/
+typedef struct {
+	fmpq_t a;		/* left end of the isolating interval */
+	fmpq_t b;		/* right end of the isolating interval */
+	int sgn_a;		/* sign of the square-free derivative of g just to the right of a */
+	fmpq_t lo;		/* lower bound of g(xi) */
+	fmpq_t hi;		/* upper bound of g(xi) */
+} crit_point_struct;
+
+/**
+	@brief		Growable list of critical points
+*/
+typedef struct {
+	crit_point_struct *pts;
+	slong num;
+	slong alloc;
+} crit_list_struct;
+
+typedef crit_list_struct crit_list_t[1];
+
+/**
+	@brief		Initializes an empty list of critical points
+	@param		list - crit_list_t list to be initialized
+*/
+void crit_list_init(crit_list_t list) {
+
+	list->pts = NULL;
+	list->num = 0;
+	list->alloc = 0;
+
+	return;
+}
+
+/**
+	@brief		Releases the memory used by the list of critical points
+	@param		list - crit_list_t list to be cleared
+*/
+void crit_list_clear(crit_list_t list) {
+
+	for (slong i = 0; i < list->num; i++) {
+		fmpq_clear(list->pts[i].a);
+		fmpq_clear(list->pts[i].b);
+		fmpq_clear(list->pts[i].lo);
+		fmpq_clear(list->pts[i].hi);
+	}
+
+	if (list->alloc > 0)
+		flint_free(list->pts);
+
+	return;
+}
+
+/**
+	@brief		Maps dyadic number c/2^k in [0, 1] to the Chebyshev variable y = 2c/2^k - 1 in [-1, 1]
+	@param		y - FLINT fmpq_t type result
+	@param		c - FLINT fmpz_t type numerator of the dyadic number
+	@param		k - FLINT slong type exponent of the denominator
+	@return		result is returned in y
+*/
+void dyadic_to_cheb(fmpq_t y, const fmpz_t c, const slong k) {
+
+	fmpz_set(&(y->num), c);
+	fmpz_one(&(y->den));
+	fmpq_div_2exp(y, y, k);
+	fmpq_mul_2exp(y, y, 1);
+
+	//(num-den)/den is canonical whenever num/den is
+	fmpz_sub(&(y->num), &(y->num), &(y->den));
+
+	return;
+}
+
+/**
+	@brief		Appends the critical point isolated in [c/2^k, (c+1)/2^k] of [0, 1], or exactly at c/2^k
+	@param		list - crit_list_t list of critical points
+	@param		c - FLINT fmpz_t type numerator of the left end
+	@param		k - FLINT slong type exponent of the denominator
+	@param		exact - if non-zero, the critical point is exactly c/2^k
+	@return		result is appended to the list
+*/
+void crit_list_push(crit_list_t list, const fmpz_t c, const slong k, const int exact) {
+
+	crit_point_struct *pt;
+
+	/* debug */
+	DEBUG_ENTER_AT(4);
+
+	if (list->num == list->alloc) {
+		list->alloc = FLINT_MAX(2*list->alloc, 4);
+		list->pts = flint_realloc(list->pts, list->alloc*sizeof(crit_point_struct));
+	}
+
+	pt = list->pts + list->num;
+	list->num++;
+
+	fmpq_init(pt->a);
+	fmpq_init(pt->b);
+	fmpq_init(pt->lo);
+	fmpq_init(pt->hi);
+	pt->sgn_a = 0;
+
+	dyadic_to_cheb(pt->a, c, k);
+
+	if (exact)
+		fmpq_set(pt->b, pt->a);
+	else {
+		fmpz_add_ui(&(pt->b->num), c, 1);
+		dyadic_to_cheb(pt->b, &(pt->b->num), k);
+	}
+
+	/* debug */
+	DEBUG_LEAVE_AT(4);
+
+	return;
+}
+
+/**
+	@brief		Autocorrelations of the coefficients of f
+	@details	C(x) = f(x)f*(x), where f*(x) = x^d f(1/x) and d = deg f, computed by fast multiplication with the reciprocal. C_{d+m} = C_{d-m} = sum_j f_j f_{j+m}.
+	@param		C - FLINT fmpz_poly_t type result
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in C
+*/
+void autocorrelations(fmpz_poly_t C, const fmpz_poly_t f) {
+
+	fmpz_poly_reverse(C, f, fmpz_poly_length(f));
+	fmpz_poly_mul(C, C, f);
+
+	return;
+}
+
+/**
+	@brief		Builds the Chebyshev form g of |f|^2 from the autocorrelations C of f
+	@details	g = C_d + 2*sum_{m=1..d} C_{d+m} T_m(y) satisfies |f(e^(it))|^2 = g(cos t).
+	@param		g - FLINT fmpz_poly_t type result
+	@param		C - FLINT fmpz_poly_t type autocorrelations of f, as computed by autocorrelations
+	@param		deg - FLINT slong type degree of f
+	@return		result is returned in g
+*/
+void autocorrelations_to_chebyshev(fmpz_poly_t g, const fmpz_poly_t C, const slong deg) {
+
+	fmpz_poly_t T_prev, T_curr, T_next;
+
+	fmpz_t c;
+
+	fmpz_poly_zero(g);
+
+	if (deg >= 0) {
+
+		fmpz_poly_init(T_prev);
+		fmpz_poly_init(T_curr);
+		fmpz_poly_init(T_next);
+		fmpz_init(c);
+
+		fmpz_poly_get_coeff_fmpz(c, C, deg);
+		fmpz_poly_set_fmpz(g, c);
+
+		fmpz_poly_one(T_prev);
+		fmpz_poly_set_coeff_si(T_curr, 1, 1);
+
+		for (slong m = 1; m <= deg; m++) {
+
+			fmpz_poly_get_coeff_fmpz(c, C, deg+m);
+			fmpz_mul_2exp(c, c, 1);
+			fmpz_poly_scalar_addmul_fmpz(g, T_curr, c);
+
+			//T_{m+1} = 2y*T_m - T_{m-1}
+			fmpz_poly_shift_left(T_next, T_curr, 1);
+			fmpz_poly_scalar_mul_2exp(T_next, T_next, 1);
+			fmpz_poly_sub(T_next, T_next, T_prev);
+
+			fmpz_poly_swap(T_prev, T_curr);
+			fmpz_poly_swap(T_curr, T_next);
+		}
+
+		fmpz_poly_clear(T_prev);
+		fmpz_poly_clear(T_curr);
+		fmpz_poly_clear(T_next);
+		fmpz_clear(c);
+	}
+
+	return;
+}
+
+/**
+	@brief		Builds the Chebyshev form of |f|^2 on the unit circle
+	@details	If C(x) = f(x)f*(x) and d = deg f, then g = C_d + 2*sum_{m=1..d} C_{d+m} T_m(y) satisfies |f(e^(it))|^2 = g(cos t). Same as f2_2chebyshev in CirclePolyTools.sage.
+	@param		g - FLINT fmpz_poly_t type result
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in g
+*/
+void f2_chebyshev(fmpz_poly_t g, const fmpz_poly_t f) {
+
+	fmpz_poly_t C;
+
+	/* debug */
+	DEBUG_ENTER_AT(2);
+
+	fmpz_poly_init(C);
+
+	autocorrelations(C, f);
+	autocorrelations_to_chebyshev(g, C, fmpz_poly_degree(f));
+
+	fmpz_poly_clear(C);
+
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+
+	return;
+}
+
+/**
+	@brief		Returns the number of sign variations in the coefficient sequence of poly
+	@param		poly - FLINT fmpz_poly_t type integer polynomial
+	@return		FLINT slong type number of sign variations
+*/
+slong sign_variations(const fmpz_poly_t poly) {
+
+	slong vars = 0;
+
+	int last_sgn = 0, curr_sgn;
+
+	for (slong i = 0; i < poly->length; i++) {
+
+		curr_sgn = fmpz_sgn(poly->coeffs+i);
+
+		if (curr_sgn != 0) {
+			if (curr_sgn != last_sgn)
+				vars++;
+			last_sgn = curr_sgn;
+		}
+	}
+
+	return(vars > 0 ? vars-1 : 0);
+}
+
+/**
+	@brief		Recursively isolates roots of poly in the open interval (0, 1) by Descartes rule of signs
+	@details	poly(x) represents the original polynomial on the interval [c/2^k, (c+1)/2^k], rescaled to [0, 1]. poly must not vanish at 0 and 1. The interval is split in halves until each part contains at most one root; roots hit exactly by the bisection are recorded as exact points.
+	@param		list - crit_list_t list of critical points, the isolated roots are appended to it
+	@param		poly - FLINT fmpz_poly_t type square-free integer polynomial, destroyed on exit
+	@param		c - FLINT fmpz_t type numerator of the left end of the interval
+	@param		k - FLINT slong type exponent of the denominator
+	@return		results are appended to list
+*/
+void isolate_roots_01(crit_list_t list, fmpz_poly_t poly, const fmpz_t c, const slong k) {
+
+	fmpz_poly_t Q;
+
+	fmpz_t shift, c_next;
+
+	slong deg, vars;
+
+	/* debug */
+	DEBUG_ENTER_AT(3);
+
+	deg = fmpz_poly_degree(poly);
+
+	if (deg <= 0) {
+
+		/* debug */
+		DEBUG_LEAVE_AT(3);
+
+		return;
+	}
+
+	fmpz_poly_init(Q);
+	fmpz_init(shift);
+	fmpz_init(c_next);
+
+	//Descartes bound for (0, 1): sign variations of (x+1)^deg poly(1/(x+1))
+	fmpz_one(shift);
+	fmpz_poly_reverse(Q, poly, deg+1);
+	fmpz_poly_taylor_shift(Q, Q, shift);
+	vars = sign_variations(Q);
+
+	/* debug */
+	DEBUG_MSG_AT(3, "# k=%wd, deg=%wd, vars=%wd\n", k, deg, vars);
+
+	if (vars == 1)
+		crit_list_push(list, c, k, 0);
+	else if (vars > 1) {
+
+		//left half: 2^deg poly(x/2), right half: its shift by 1
+		for (slong i = 0; i < deg; i++)
+			fmpz_mul_2exp(poly->coeffs+i, poly->coeffs+i, deg-i);
+		fmpz_poly_taylor_shift(Q, poly, shift);
+
+		fmpz_mul_2exp(c_next, c, 1);
+		fmpz_add_ui(c_next, c_next, 1);
+
+		if (fmpz_is_zero(Q->coeffs)) {
+
+			//root exactly in the middle: record it and divide it out from both halves
+			crit_list_push(list, c_next, k+1, 1);
+
+			fmpz_poly_shift_right(Q, Q, 1);
+			fmpz_set_si(shift, -1);
+			fmpz_poly_taylor_shift(poly, Q, shift);
+		}
+
+		fmpz_poly_primitive_part(poly, poly);
+		fmpz_poly_primitive_part(Q, Q);
+
+		isolate_roots_01(list, Q, c_next, k+1);
+
+		fmpz_sub_ui(c_next, c_next, 1);
+		isolate_roots_01(list, poly, c_next, k+1);
+	}
+
+	fmpz_poly_clear(Q);
+	fmpz_clear(shift);
+	fmpz_clear(c_next);
+
+	/* debug */
+	DEBUG_LEAVE_AT(3);
+
+	return;
+}
+
+/**
+	@brief		Computes the square-free part of g' with the roots at y = -1 and y = 1 removed
+	@details	The endpoints y = -1, 1 are always examined separately, so only the critical points inside (-1, 1) are kept.
+	@param		h - FLINT fmpz_poly_t type result
+	@param		g - FLINT fmpz_poly_t type integer polynomial
+	@return		result is returned in h
+*/
+void critical_poly(fmpz_poly_t h, const fmpz_poly_t g) {
+
+	fmpz_poly_t D;
+
+	fmpz_t y, val;
+
+	/* debug */
+	DEBUG_ENTER_AT(2);
+
+	fmpz_poly_derivative(h, g);
+
+	if (fmpz_poly_degree(h) > 0) {
+
+		fmpz_poly_init(D);
+		fmpz_init(y);
+		fmpz_init(val);
+
+		fmpz_poly_derivative(D, h);
+		fmpz_poly_gcd(D, h, D);
+		fmpz_poly_div(h, h, D);
+		fmpz_poly_primitive_part(h, h);
+
+		//square-free h can vanish at most once at each endpoint
+		for (slong s = -1; s <= 1; s += 2) {
+
+			fmpz_set_si(y, s);
+			fmpz_poly_evaluate_fmpz(val, h, y);
+
+			if (fmpz_is_zero(val)) {
+				fmpz_poly_zero(D);
+				fmpz_poly_set_coeff_si(D, 1, 1);
+				fmpz_poly_set_coeff_si(D, 0, -s);
+				fmpz_poly_div(h, h, D);
+			}
+		}
+
+		fmpz_poly_clear(D);
+		fmpz_clear(y);
+		fmpz_clear(val);
+	}
+
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+
+	return;
+}
+
+/**
+	@brief		Isolates all roots of h inside (-1, 1)
+	@param		list - crit_list_t list of critical points, the isolated roots are appended to it
+	@param		h - FLINT fmpz_poly_t type square-free integer polynomial with h(-1), h(1) <> 0
+	@return		results are appended to list, with sgn_a initialized
+*/
+void isolate_critical_points(crit_list_t list, const fmpz_poly_t h) {
+
+	fmpz_poly_t P, D;
+
+	fmpz_t c;
+
+	fmpq_t val;
+
+	/* debug */
+	DEBUG_ENTER_AT(2);
+
+	fmpz_poly_init(P);
+	fmpz_poly_init(D);
+	fmpz_init(c);
+	fmpq_init(val);
+
+	//P(x) = h(2x-1) on [0, 1]
+	fmpz_set_si(c, -1);
+	fmpz_poly_taylor_shift(P, h, c);
+	for (slong i = 1; i < P->length; i++)
+		fmpz_mul_2exp(P->coeffs+i, P->coeffs+i, i);
+
+	fmpz_zero(c);
+	isolate_roots_01(list, P, c, 0);
+
+	//sign of h just to the right of a; a can be an exact root found by the bisection, then h'(a) <> 0
+	fmpz_poly_derivative(D, h);
+	for (slong i = 0; i < list->num; i++) {
+		fmpz_poly_evaluate_fmpq(val, h, list->pts[i].a);
+		if (fmpq_is_zero(val))
+			fmpz_poly_evaluate_fmpq(val, D, list->pts[i].a);
+		list->pts[i].sgn_a = fmpq_sgn(val);
+	}
+
+	/* debug */
+	DEBUG_MSG_AT(2, "# %wd critical points isolated\n", list->num);
+
+	fmpz_poly_clear(P);
+	fmpz_poly_clear(D);
+	fmpz_clear(c);
+	fmpq_clear(val);
+
+	/* debug */
+	DEBUG_LEAVE_AT(2);
+
+	return;
+}
+
+/**
+	@brief		Encloses the critical value g(xi) of the critical point pt
+	@details	[lo, hi] = g(m) -/+ K*r^2/2, where m is the midpoint, r is the half-width of the isolating interval [a, b] and K = min(B2, S/(1-max(a^2, b^2))) bounds |g''| on [a, b]
+	@param		pt - pointer to the critical point
+	@param		g - FLINT fmpz_poly_t type integer polynomial
+	@param		B2 - FLINT fmpz_t type upper bound of |g''| on [-1, 1]
+	@param		S - FLINT fmpz_t type, |g''(y)| <= S/(1-y^2) on (-1, 1)
+	@return		results are stored in pt->lo, pt->hi
+*/
+void crit_point_enclose(crit_point_struct *pt, const fmpz_poly_t g, const fmpz_t B2, const fmpz_t S) {
+
+	fmpq_t mid, err, K;
+
+	if (fmpq_equal(pt->a, pt->b)) {
+		fmpz_poly_evaluate_fmpq(pt->lo, g, pt->a);
+		fmpq_set(pt->hi, pt->lo);
+
+		return;
+	}
+
+	fmpq_init(mid);
+	fmpq_init(err);
+	fmpq_init(K);
+
+	//K = min(B2, S/(1-max(a^2, b^2))), the local bound is much smaller away from y = -1, 1
+	fmpz_set(&(K->num), B2);
+	fmpz_one(&(K->den));
+
+	fmpq_mul(err, pt->a, pt->a);
+	fmpq_mul(mid, pt->b, pt->b);
+	if (fmpq_cmp(mid, err) > 0)
+		fmpq_swap(mid, err);
+
+	//(den-num)/den is canonical whenever num/den is
+	fmpz_sub(&(err->num), &(err->den), &(err->num));
+
+	if (fmpz_sgn(&(err->num)) > 0) {
+		fmpq_inv(err, err);
+		fmpq_mul_fmpz(err, err, S);
+		if (fmpq_cmp(err, K) < 0)
+			fmpq_swap(K, err);
+	}
+
+	fmpq_add(mid, pt->a, pt->b);
+	fmpq_div_2exp(mid, mid, 1);
+	fmpz_poly_evaluate_fmpq(pt->lo, g, mid);
+
+	fmpq_sub(err, pt->b, pt->a);
+	fmpq_div_2exp(err, err, 1);
+	fmpq_mul(err, err, err);
+	fmpq_mul(err, err, K);
+	fmpq_div_2exp(err, err, 1);
+
+	fmpq_add(pt->hi, pt->lo, err);
+	fmpq_sub(pt->lo, pt->lo, err);
+
+	fmpq_clear(mid);
+	fmpq_clear(err);
+	fmpq_clear(K);
+
+	return;
+}
+
+/**
+	@brief		Halves the isolating interval of the critical point pt and updates the enclosure of g(xi)
+	@param		pt - pointer to the critical point
+	@param		g - FLINT fmpz_poly_t type integer polynomial
+	@param		h - FLINT fmpz_poly_t type square-free part of g'
+	@param		B2 - FLINT fmpz_t type upper bound of |g''| on [-1, 1]
+	@param		S - FLINT fmpz_t type, |g''(y)| <= S/(1-y^2) on (-1, 1)
+	@return		results are stored in pt
+*/
+void crit_point_refine(crit_point_struct *pt, const fmpz_poly_t g, const fmpz_poly_t h, const fmpz_t B2, const fmpz_t S) {
+
+	fmpq_t mid, val;
+
+	int mid_sgn;
+
+	if (fmpq_equal(pt->a, pt->b))
+		return;
+
+	fmpq_init(mid);
+	fmpq_init(val);
+
+	fmpq_add(mid, pt->a, pt->b);
+	fmpq_div_2exp(mid, mid, 1);
+	fmpz_poly_evaluate_fmpq(val, h, mid);
+	mid_sgn = fmpq_sgn(val);
+
+	if (mid_sgn == 0) {
+		fmpq_set(pt->a, mid);
+		fmpq_set(pt->b, mid);
+	}
+	else if (mid_sgn == pt->sgn_a)
+		fmpq_set(pt->a, mid);
+	else
+		fmpq_set(pt->b, mid);
+
+	crit_point_enclose(pt, g, B2, S);
+
+	fmpq_clear(mid);
+	fmpq_clear(val);
+
+	return;
+}
+
+/**
+	@brief		Upper bounds for |g''(y)|, where g is the Chebyshev form of |f|^2
+	@details	Since |T_m''(y)| <= T_m''(1) = m^2(m^2-1)/3 on [-1, 1], |g''| <= B2 = 2*sum_{m=2..d} |C_{d+m}| m^2(m^2-1)/3 with C(x) = f(x)f*(x) as in autocorrelations_to_chebyshev. This grows polynomially in d = deg f, while the coefficients of g in the monomial basis grow like (1+sqrt(2))^d. Away from y = -1, 1 the bound |T_m''(y)| <= 2m^2/(1-y^2), which follows from |sin(mt)| <= m|sin(t)| for y = cos(t), gives |g''(y)| <= S/(1-y^2) with S = 4*sum_{m=2..d} |C_{d+m}| m^2.
+	@param		B2 - FLINT fmpz_t type result, bound on [-1, 1]
+	@param		S - FLINT fmpz_t type result, numerator of the local bound
+	@param		C - FLINT fmpz_poly_t type autocorrelations of f, as computed by autocorrelations
+	@param		deg - FLINT slong type degree of f
+	@return		results are returned in B2, S
+*/
+void second_derivative_bound(fmpz_t B2, fmpz_t S, const fmpz_poly_t C, const slong deg) {
+
+	fmpz_t c;
+
+	ulong a, b;
+
+	fmpz_zero(B2);
+	fmpz_zero(S);
+
+	if (deg >= 2) {
+
+		fmpz_init(c);
+
+		for (slong m = 2; m <= deg; m++) {
+
+			//m^2(m^2-1)/3: 3 divides m^2 or m^2-1
+			a = (ulong) m*m;
+			b = a-1;
+			if (a % 3 == 0)
+				a /= 3;
+			else
+				b /= 3;
+
+			fmpz_poly_get_coeff_fmpz(c, C, deg+m);
+			fmpz_abs(c, c);
+			fmpz_addmul_ui(S, c, (ulong) m*m);
+			fmpz_mul_ui(c, c, a);
+			fmpz_mul_ui(c, c, b);
+			fmpz_add(B2, B2, c);
+		}
+
+		fmpz_mul_2exp(B2, B2, 1);
+		fmpz_mul_2exp(S, S, 2);
+
+		fmpz_clear(c);
+	}
+
+	return;
+}
+
+/**
+	@brief		Certified enclosure of min g(y) or max g(y) on [-1, 1]
+	@details	Best-first search: the critical point with the lowest enclosure that can still compete for the extremum is refined, until the enclosure of the extremum is at most 2^(-prec) wide.
+	@param		lo - FLINT fmpq_t type lower bound of the extremum
+	@param		hi - FLINT fmpq_t type upper bound of the extremum
+	@param		poly - FLINT fmpz_poly_t type integer polynomial g
+	@param		h - FLINT fmpz_poly_t type square-free part of g', as computed by critical_poly
+	@param		list - critical points of g, as isolated by isolate_critical_points; the isolating intervals are only narrowed, so the list can be reused for the other extremum
+	@param		B2 - FLINT fmpz_t type upper bound of |g''| on [-1, 1]
+	@param		S - FLINT fmpz_t type, |g''(y)| <= S/(1-y^2) on (-1, 1)
+	@param		find_max - if non-zero, the maximum is enclosed, otherwise the minimum
+	@param		prec - FLINT slong type, the requested enclosure width is 2^(-prec)
+	@return		results are returned in lo, hi
+*/
+void cheb_extremum(fmpq_t lo, fmpq_t hi, const fmpz_poly_t poly, const fmpz_poly_t h, crit_list_t list, const fmpz_t B2, const fmpz_t S, const int find_max, const slong prec) {
+
+	fmpz_poly_t g;
+
+	fmpz_t y, val, val1;
+
+	fmpq_t ends, eps, width;
+
+	crit_point_struct *pt;
+
+	/* debug */
+	DEBUG_ENTER_AT(1);
+
+	fmpz_poly_init(g);
+	fmpz_init(y);
+	fmpz_init(val);
+	fmpz_init(val1);
+	fmpq_init(ends);
+	fmpq_init(eps);
+	fmpq_init(width);
+
+	//max g = -min(-g)
+	if (find_max)
+		fmpz_poly_neg(g, poly);
+	else
+		fmpz_poly_set(g, poly);
+
+	//endpoints y = -1, 1 are exact candidates
+	fmpz_set_si(y, -1);
+	fmpz_poly_evaluate_fmpz(val, g, y);
+	fmpz_one(y);
+	fmpz_poly_evaluate_fmpz(val1, g, y);
+	if (fmpz_cmp(val1, val) < 0)
+		fmpz_set(val, val1);
+	fmpq_set_fmpz_frac(ends, val, y);
+
+	//the critical points of -g are those of g
+	for (slong i = 0; i < list->num; i++)
+		crit_point_enclose(list->pts+i, g, B2, S);
+
+	fmpq_one(eps);
+	fmpq_div_2exp(eps, eps, prec);
+
+	do {
+
+		fmpq_set(hi, ends);
+		for (slong i = 0; i < list->num; i++)
+			if (fmpq_cmp(list->pts[i].hi, hi) < 0)
+				fmpq_set(hi, list->pts[i].hi);
+
+		//lowest enclosure among the points that are still competing and too wide
+		pt = NULL;
+
+		for (slong i = 0; i < list->num; i++) {
+
+			fmpq_sub(width, list->pts[i].hi, list->pts[i].lo);
+
+			if ((fmpq_cmp(list->pts[i].lo, hi) < 0) && (fmpq_cmp(width, eps) > 0))
+				if ((pt == NULL) || (fmpq_cmp(list->pts[i].lo, pt->lo) < 0))
+					pt = list->pts+i;
+		}
+
+		if (pt != NULL)
+			crit_point_refine(pt, g, h, B2, S);
+
+	} while (pt != NULL);
+
+	fmpq_set(lo, ends);
+	for (slong i = 0; i < list->num; i++)
+		if (fmpq_cmp(list->pts[i].lo, lo) < 0)
+			fmpq_set(lo, list->pts[i].lo);
+
+	if (find_max) {
+		fmpq_neg(lo, lo);
+		fmpq_neg(hi, hi);
+		fmpq_swap(lo, hi);
+	}
+
+	/* debug */
+	DEBUG_MSG_AT(1, "# extremum of g in [");
+	DEBUG_FMPQ_AT(1, lo);
+	DEBUG_MSG_AT(1, ", ");
+	DEBUG_FMPQ_AT(1, hi);
+	DEBUG_MSG_AT(1, "]\n");
+
+	fmpz_poly_clear(g);
+	fmpz_clear(y);
+	fmpz_clear(val);
+	fmpz_clear(val1);
+	fmpq_clear(ends);
+	fmpq_clear(eps);
+	fmpq_clear(width);
+
+	/* debug */
+	DEBUG_LEAVE_AT(1);
+
+	return;
+}
+
+/**
+	@brief		Encloses square roots of the rational bounds lo2 <= hi2 by dyadic numbers with denominator 2^prec
+	@param		lo - FLINT fmpq_t type, lo <= sqrt(max(lo2, 0))
+	@param		hi - FLINT fmpq_t type, hi >= sqrt(max(hi2, 0))
+	@param		lo2 - FLINT fmpq_t type lower bound
+	@param		hi2 - FLINT fmpq_t type upper bound
+	@param		prec - FLINT slong type number of fractional bits
+	@return		results are returned in lo, hi
+*/
+void sqrt_enclose(fmpq_t lo, fmpq_t hi, const fmpq_t lo2, const fmpq_t hi2, const slong prec) {
+
+	fmpz_t s, r;
+
+	fmpz_init(s);
+	fmpz_init(r);
+
+	//lo = floor(sqrt(floor(lo2*4^prec)))/2^prec
+	fmpz_mul_2exp(r, &(lo2->num), 2*prec);
+	fmpz_fdiv_q(r, r, &(lo2->den));
+	if (fmpz_sgn(r) < 0)
+		fmpz_zero(r);
+	fmpz_sqrt(s, r);
+	fmpz_set(&(lo->num), s);
+	fmpz_one(&(lo->den));
+	fmpq_div_2exp(lo, lo, prec);
+
+	//hi = ceil(sqrt(ceil(hi2*4^prec)))/2^prec
+	fmpz_mul_2exp(r, &(hi2->num), 2*prec);
+	fmpz_cdiv_q(r, r, &(hi2->den));
+	if (fmpz_sgn(r) < 0)
+		fmpz_zero(r);
+	fmpz_sqrtrem(s, r, r);
+	if (!fmpz_is_zero(r))
+		fmpz_add_ui(s, s, 1);
+	fmpz_set(&(hi->num), s);
+	fmpz_one(&(hi->den));
+	fmpq_div_2exp(hi, hi, prec);
+
+	fmpz_clear(s);
+	fmpz_clear(r);
+
+	return;
+}
+
+/**
+	@brief		Prepares the search for the extrema of |f| on the unit circle
+	@details	The autocorrelations C of f are computed once and give both the Chebyshev form g of |f|^2 and the bounds on |g''|.
+	@param		g - FLINT fmpz_poly_t type result, Chebyshev form of |f|^2
+	@param		h - FLINT fmpz_poly_t type result, square-free part of g'
+	@param		list - result, isolated critical points of g
+	@param		B2 - FLINT fmpz_t type result, upper bound of |g''| on [-1, 1]
+	@param		S - FLINT fmpz_t type result, |g''(y)| <= S/(1-y^2) on (-1, 1)
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@return		results are returned in g, h, list, B2, S
+*/
+void circle_setup(fmpz_poly_t g, fmpz_poly_t h, crit_list_t list, fmpz_t B2, fmpz_t S, const fmpz_poly_t f) {
+
+	fmpz_poly_t C;
+
+	fmpz_poly_init(C);
+
+	autocorrelations(C, f);
+	autocorrelations_to_chebyshev(g, C, fmpz_poly_degree(f));
+	second_derivative_bound(B2, S, C, fmpz_poly_degree(f));
+
+	critical_poly(h, g);
+	isolate_critical_points(list, h);
+
+	fmpz_poly_clear(C);
+
+	return;
+}
+
+/**
+	@brief		Certified enclosure of min |f(z)| on the unit circle |z| = 1
+	@details	lo <= min |f| <= hi and hi - lo <= 2^(-prec). Native version of circle_min in CirclePolyTools.sage.
+	@param		lo - FLINT fmpq_t type lower bound
+	@param		hi - FLINT fmpq_t type upper bound
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@param		prec - FLINT slong type, the requested enclosure width is 2^(-prec)
+	@return		results are returned in lo, hi
+*/
+void circle_min(fmpq_t lo, fmpq_t hi, const fmpz_poly_t f, const slong prec) {
+
+	fmpz_poly_t g, h;
+
+	fmpz_t B2, S;
+
+	fmpq_t lo2, hi2;
+
+	crit_list_t list;
+
+	/* debug */
+	DEBUG_ENTER_AT(1);
+
+	fmpz_poly_init(g);
+	fmpz_poly_init(h);
+	fmpz_init(B2);
+	fmpz_init(S);
+	fmpq_init(lo2);
+	fmpq_init(hi2);
+	crit_list_init(list);
+
+	//width of the square root enclosure is at most sqrt(hi2-lo2) + 2^(-prec-1)
+	circle_setup(g, h, list, B2, S, f);
+	cheb_extremum(lo2, hi2, g, h, list, B2, S, 0, 2*prec+2);
+	sqrt_enclose(lo, hi, lo2, hi2, prec+2);
+
+	fmpz_poly_clear(g);
+	fmpz_poly_clear(h);
+	fmpz_clear(B2);
+	fmpz_clear(S);
+	fmpq_clear(lo2);
+	fmpq_clear(hi2);
+	crit_list_clear(list);
+
+	/* debug */
+	DEBUG_LEAVE_AT(1);
+
+	return;
+}
+
+/**
+	@brief		Certified enclosure of max |f(z)| on the unit circle |z| = 1
+	@details	lo <= max |f| <= hi and hi - lo <= 2^(-prec). Native version of circle_max in CirclePolyTools.sage.
+	@param		lo - FLINT fmpq_t type lower bound
+	@param		hi - FLINT fmpq_t type upper bound
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@param		prec - FLINT slong type, the requested enclosure width is 2^(-prec)
+	@return		results are returned in lo, hi
+*/
+void circle_max(fmpq_t lo, fmpq_t hi, const fmpz_poly_t f, const slong prec) {
+
+	fmpz_poly_t g, h;
+
+	fmpz_t B2, S;
+
+	fmpq_t lo2, hi2;
+
+	crit_list_t list;
+
+	/* debug */
+	DEBUG_ENTER_AT(1);
+
+	fmpz_poly_init(g);
+	fmpz_poly_init(h);
+	fmpz_init(B2);
+	fmpz_init(S);
+	fmpq_init(lo2);
+	fmpq_init(hi2);
+	crit_list_init(list);
+
+	circle_setup(g, h, list, B2, S, f);
+	cheb_extremum(lo2, hi2, g, h, list, B2, S, 1, 2*prec+2);
+	sqrt_enclose(lo, hi, lo2, hi2, prec+2);
+
+	fmpz_poly_clear(g);
+	fmpz_poly_clear(h);
+	fmpz_clear(B2);
+	fmpz_clear(S);
+	fmpq_clear(lo2);
+	fmpq_clear(hi2);
+	crit_list_clear(list);
+
+	/* debug */
+	DEBUG_LEAVE_AT(1);
+
+	return;
+}
+
+/**
+	@brief		Certified enclosures of both min |f(z)| and max |f(z)| on the unit circle |z| = 1
+	@details	Same results as circle_min and circle_max, but g, its critical points and the bounds on |g''| are computed only once.
+	@param		min_lo - FLINT fmpq_t type lower bound of the minimum
+	@param		min_hi - FLINT fmpq_t type upper bound of the minimum
+	@param		max_lo - FLINT fmpq_t type lower bound of the maximum
+	@param		max_hi - FLINT fmpq_t type upper bound of the maximum
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@param		prec - FLINT slong type, the requested enclosure width is 2^(-prec)
+	@return		results are returned in min_lo, min_hi, max_lo, max_hi
+*/
+void circle_min_max(fmpq_t min_lo, fmpq_t min_hi, fmpq_t max_lo, fmpq_t max_hi, const fmpz_poly_t f, const slong prec) {
+
+	fmpz_poly_t g, h;
+
+	fmpz_t B2, S;
+
+	fmpq_t lo2, hi2;
+
+	crit_list_t list;
+
+	/* debug */
+	DEBUG_ENTER_AT(1);
+
+	fmpz_poly_init(g);
+	fmpz_poly_init(h);
+	fmpz_init(B2);
+	fmpz_init(S);
+	fmpq_init(lo2);
+	fmpq_init(hi2);
+	crit_list_init(list);
+
+	circle_setup(g, h, list, B2, S, f);
+
+	cheb_extremum(lo2, hi2, g, h, list, B2, S, 0, 2*prec+2);
+	sqrt_enclose(min_lo, min_hi, lo2, hi2, prec+2);
+
+	cheb_extremum(lo2, hi2, g, h, list, B2, S, 1, 2*prec+2);
+	sqrt_enclose(max_lo, max_hi, lo2, hi2, prec+2);
+
+	fmpz_poly_clear(g);
+	fmpz_poly_clear(h);
+	fmpz_clear(B2);
+	fmpz_clear(S);
+	fmpq_clear(lo2);
+	fmpq_clear(hi2);
+	crit_list_clear(list);
+
+	/* debug */
+	DEBUG_LEAVE_AT(1);
+
+	return;
+}
+
+/**
+	@brief		Threshold test: decides whether |f(z)| > bound everywhere on the unit circle |z| = 1
+	@details	Stops as soon as the answer is proven: each critical point is refined only until its critical value is separated from bound^2, and the search ends at the first point where |f| <= bound. Critical values exactly equal to bound^2 are detected by gcd(g', g - bound^2), which guarantees termination.
+	@param		f - FLINT fmpz_poly_t type integer polynomial
+	@param		bound - FLINT fmpq_t type threshold
+	@return		1 if min |f| > bound on the unit circle, 0 otherwise
+*/
+int circle_min_exceeds(const fmpz_poly_t f, const fmpq_t bound) {
+
+	fmpz_poly_t C, g, h, G;
+
+	fmpz_t B2, S, y, val;
+
+	fmpq_t t, val_a, val_b;
+
+	crit_list_t list;
+
+	crit_point_struct *pt;
+
+	int result;
+
+	/* debug */
+	DEBUG_ENTER_AT(1);
+
+	if (fmpq_sgn(bound) < 0) {
+
+		/* debug */
+		DEBUG_LEAVE_AT(1);
+
+		return(1);
+	}
+
+	fmpz_poly_init(C);
+	fmpz_poly_init(g);
+	fmpz_poly_init(h);
+	fmpz_poly_init(G);
+	fmpz_init(B2);
+	fmpz_init(S);
+	fmpz_init(y);
+	fmpz_init(val);
+	fmpq_init(t);
+	fmpq_init(val_a);
+	fmpq_init(val_b);
+	crit_list_init(list);
+
+	result = 1;
+
+	autocorrelations(C, f);
+	autocorrelations_to_chebyshev(g, C, fmpz_poly_degree(f));
+	fmpq_mul(t, bound, bound);
+
+	//endpoints y = -1, 1: g(y) <= t iff den(t)*g(y) <= num(t)
+	for (slong s = -1; (s <= 1) && result; s += 2) {
+		fmpz_set_si(y, s);
+		fmpz_poly_evaluate_fmpz(val, g, y);
+		fmpz_mul(val, val, &(t->den));
+		if (fmpz_cmp(val, &(t->num)) <= 0)
+			result = 0;
+	}
+
+	if (result) {
+
+		critical_poly(h, g);
+		second_derivative_bound(B2, S, C, fmpz_poly_degree(f));
+
+		//G(y) <> const iff some critical value is exactly t
+		fmpz_poly_scalar_mul_fmpz(G, g, &(t->den));
+		fmpz_poly_get_coeff_fmpz(val, G, 0);
+		fmpz_sub(val, val, &(t->num));
+		fmpz_poly_set_coeff_fmpz(G, 0, val);
+		fmpz_poly_gcd(G, G, h);
+
+		isolate_critical_points(list, h);
+
+		for (slong i = 0; (i < list->num) && result; i++) {
+
+			pt = list->pts+i;
+
+			if ((fmpz_poly_degree(G) > 0) && !fmpq_equal(pt->a, pt->b)) {
+				fmpz_poly_evaluate_fmpq(val_a, G, pt->a);
+				fmpz_poly_evaluate_fmpq(val_b, G, pt->b);
+				if (fmpq_sgn(val_a) != fmpq_sgn(val_b)) {
+					result = 0;
+					break;
+				}
+			}
+
+			crit_point_enclose(pt, g, B2, S);
+
+			while (fmpq_cmp(pt->lo, t) <= 0) {
+
+				if (fmpq_cmp(pt->hi, t) <= 0) {
+					result = 0;
+					break;
+				}
+
+				crit_point_refine(pt, g, h, B2, S);
+			}
+		}
+	}
+
+	/* debug */
+	DEBUG_MSG_AT(1, "# min |f| > bound: %d\n", result);
+
+	fmpz_poly_clear(C);
+	fmpz_poly_clear(g);
+	fmpz_poly_clear(h);
+	fmpz_poly_clear(G);
+	fmpz_clear(B2);
+	fmpz_clear(S);
+	fmpz_clear(y);
+	fmpz_clear(val);
+	fmpq_clear(t);
+	fmpq_clear(val_a);
+	fmpq_clear(val_b);
+	crit_list_clear(list);
+
+	/* debug */
+	DEBUG_LEAVE_AT(1);
+
+	return(result);
+}
@@ -4,15 +4,22 @@
 	@version	1.0
 	@note		Flint version 2.5.2
 	@brief		Header file for the polynomial zero counting function prototypes
-	@details	Currently contains only the prototype of the Bistritz algorithm procedure, used to count the number of complex zeros of a polynomial P(x) of Q[x] inside and on the boundary of complex unit circle Disk(0, 1) = {z: |z| <= 1}.
+	@details	Contains the prototype of the Bistritz algorithm procedure, used to count the number of complex zeros of a polynomial P(x) of Q[x] inside and on the boundary of complex unit circle Disk(0, 1) = {z: |z| <= 1}, and the prototypes of certified minimum/maximum of |f(z)| on the unit circle |z| = 1 for f(x) in Z[x].
 */
 
 #ifndef ZEROCOUNT_H
 	
 	#define ZEROCOUNT_H
+	#include "flint/fmpz_poly.h"
 	#include "flint/fmpq_poly.h"
 
 	void Bistritz_rule(slong *, slong *, const fmpq_poly_t);
 
+	void f2_chebyshev(fmpz_poly_t, const fmpz_poly_t);
+	void circle_min(fmpq_t, fmpq_t, const fmpz_poly_t, const slong);
+	void circle_max(fmpq_t, fmpq_t, const fmpz_poly_t, const slong);
+	void circle_min_max(fmpq_t, fmpq_t, fmpq_t, fmpq_t, const fmpz_poly_t, const slong);
+	int circle_min_exceeds(const fmpz_poly_t, const fmpq_t);
+
 
 #endif
\ No newline at end of file